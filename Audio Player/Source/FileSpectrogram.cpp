@@ -0,0 +1,198 @@
+#include "FileSpectrogram.h"
+
+using namespace juce;
+
+//==============================================================================
+//  [firstFrame, endFrame) ֡ÿʹԼĽFFT
+class FileSpectrogram::AnalysisJob : public ThreadPoolJob
+{
+public:
+    AnalysisJob(FileSpectrogram& o, AudioFormatReader* r, int first, int end)
+        : ThreadPoolJob("FileSpectrogram"),
+        owner(o),
+        reader(r),
+        forwardFFT(fftOrder),
+        firstFrame(first),
+        endFrame(end),
+        buffer((int)r->numChannels, fftSize)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        for (auto frame = firstFrame; frame < endFrame; ++frame)
+        {
+            if (shouldExit())
+            {
+                owner.jobFinished(false);
+                return jobHasFinished;
+            }
+
+            reader->read(&buffer, 0, fftSize, (int64)frame * owner.hopSize, true, true);
+
+            // ȡƽдFFT
+            zeromem(fftData, sizeof(fftData));
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                FloatVectorOperations::add(fftData, buffer.getReadPointer(channel), fftSize);
+            FloatVectorOperations::multiply(fftData, 1.0f / (float)jmax(1, buffer.getNumChannels()), fftSize);
+
+            owner.window.multiplyWithWindowingTable(fftData, fftSize);
+            forwardFFT.performFrequencyOnlyForwardTransform(fftData);
+
+            // תΪdBΪ8λhannΪ0.5
+            auto* out = owner.magnitudes + (size_t)frame * numBins;
+            for (auto bin = 0; bin < numBins; ++bin)
+            {
+                auto db = Decibels::gainToDecibels(fftData[bin] * 4.0f / (float)fftSize, -96.0f);
+                out[bin] = (uint8)roundToInt(jmap(jlimit(-96.0f, 0.0f, db), -96.0f, 0.0f, 0.0f, 255.0f));
+            }
+        }
+
+        owner.jobFinished(true);
+        return jobHasFinished;
+    }
+
+private:
+    FileSpectrogram& owner;
+    std::unique_ptr<AudioFormatReader> reader;
+    dsp::FFT forwardFFT;
+    int firstFrame, endFrame;
+    AudioSampleBuffer buffer;
+    float fftData[2 * fftSize];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisJob)
+};
+
+//==============================================================================
+FileSpectrogram::FileSpectrogram()
+    :window(fftSize, dsp::WindowingFunction<float>::hann, false)
+{
+}
+
+FileSpectrogram::~FileSpectrogram()
+{
+    cancel();
+}
+
+void FileSpectrogram::cancel()
+{
+    cancelled = true;
+
+    // 賬ʱÿ֡ǷҪ˳ͷŻ· magnitudes
+    if (pool != nullptr)
+        pool->removeAllJobs(true, -1);
+
+    ready = false;
+    failed = false;
+}
+
+void FileSpectrogram::analyse(const File& file, AudioFormatManager& formatManager)
+{
+    cancel();
+
+    numFrames = 0;
+    framesPerSecond = 0.0;
+    lengthInSeconds = 0.0;
+    cancelled = false;
+
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples < fftSize)
+    {
+        failed = true;
+        sendChangeMessage();
+        return;
+    }
+
+    // ֡ΪһFFTȣ֤ÿӵ֡ maxFramesPerMinute
+    hopSize = jmax((int)fftSize, (int)std::ceil(reader->sampleRate * 60.0 / maxFramesPerMinute));
+    numFrames = (int)((reader->lengthInSamples - fftSize) / hopSize) + 1;
+    lengthInSeconds = (double)reader->lengthInSamples / reader->sampleRate;
+    magnitudes.malloc((size_t)numFrames * numBins);
+
+    if (pool == nullptr)
+        pool.reset(new ThreadPool(SystemStats::getNumCpus()));
+
+    // ÿCPUһÿ񵥶һ
+    auto numJobs = jmin(numFrames, pool->getNumThreads());
+    auto framesPerJob = (numFrames + numJobs - 1) / numJobs;
+
+    jobFailed = false;
+    jobsRemaining = numJobs;
+    startTicks = Time::getHighResolutionTicks();
+
+    for (auto i = 0; i < numJobs; ++i)
+    {
+        auto* jobReader = i == 0 ? reader.release() : formatManager.createReaderFor(file);
+
+        if (jobReader == nullptr)
+        {
+            jobFinished(false);
+            continue;
+        }
+
+        auto first = i * framesPerJob;
+        pool->addJob(new AnalysisJob(*this, jobReader, first, jmin(numFrames, first + framesPerJob)), true);
+    }
+}
+
+void FileSpectrogram::jobFinished(bool completed)
+{
+    if (!completed)
+        jobFailed = true;
+
+    if (--jobsRemaining != 0)
+        return;
+
+    //  cancel() ȡʱ֪ͨȴһμĽ
+    if (jobFailed)
+    {
+        if (!cancelled)
+        {
+            failed = true;
+            sendChangeMessage();
+        }
+    }
+    else
+    {
+        auto seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+        framesPerSecond = numFrames / jmax(seconds, 1e-6);
+
+        DBG("FileSpectrogram: " << numFrames << " frames in " << seconds << " s, "
+            << framesPerSecond << " frames/s, "
+            << (int)(getMemoryBytes() / 1024 / jmax(lengthInSeconds / 60.0, 1.0 / 60.0)) << " KB/min");
+
+        ready = true;
+        sendChangeMessage();
+    }
+}
+
+Image FileSpectrogram::createImage(int width, int height) const
+{
+    Image image(Image::RGB, width, height, true);
+
+    if (!isReady() || numFrames == 0)
+        return image;
+
+    for (auto x = 0; x < width; ++x)
+    {
+        // ֡ѹһʱȡֵ
+        auto firstFrame = (int)((int64)x * numFrames / width);
+        auto endFrame = jmax(firstFrame + 1, (int)((int64)(x + 1) * numFrames / width));
+
+        for (auto y = 1; y < height; ++y)
+        {
+            auto skewedProportionY = 1.0f - std::exp(std::log((float)y / (float)height) * 0.2f);
+            auto bin = jlimit(0, numBins - 1, (int)(skewedProportionY * (int)numBins));
+
+            uint8 level = 0;
+            for (auto frame = firstFrame; frame < endFrame; ++frame)
+                level = jmax(level, getFrame(frame)[bin]);
+
+            auto proportion = level / 255.0f;
+            image.setPixelAt(x, y, Colour::fromHSV(proportion, 1.0f, proportion, 1.0f));
+        }
+    }
+
+    return image;
+}
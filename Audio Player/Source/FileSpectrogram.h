@@ -0,0 +1,67 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+using namespace juce;
+//==============================================================================
+
+// ļƵ(STFT)ļʱ̳߳а֡䲢м
+// ÿ֡ numBins ķ(uint8, Ӧ -96dB ~ 0dB)ֱʾ϶λ
+class FileSpectrogram : public juce::ChangeBroadcaster
+{
+public:
+    enum
+    {
+        fftOrder = 10,
+        fftSize = 1 << fftOrder,
+        numBins = fftSize / 2,
+        maxFramesPerMinute = 3000 //ÿƵౣ֡ڴΪ maxFramesPerMinute * numBins ֽ/
+    };
+
+    FileSpectrogram();
+    ~FileSpectrogram() override;
+
+    void analyse(const juce::File& file, juce::AudioFormatManager& formatManager); //ȡһμ㣬ʼļ
+    void cancel();
+
+    // ɻʧ(ļ޷롢һFFTȻ)ʱᷢͱ仯Ϣ
+    bool isReady() const noexcept { return ready.load(); }
+    bool hasFailed() const noexcept { return failed.load(); }
+    int getNumFrames() const noexcept { return numFrames; }
+    int getHopSize() const noexcept { return hopSize; }
+    double getLengthInSeconds() const noexcept { return lengthInSeconds; }
+    double getFramesPerSecond() const noexcept { return framesPerSecond; } //֡/
+    size_t getMemoryBytes() const noexcept { return (size_t)numFrames * numBins; }
+
+    const juce::uint8* getFrame(int frameIndex) const noexcept { return magnitudes + (size_t)frameIndex * numBins; }
+
+    // ʵʱƵʹͬĴ
+    juce::dsp::WindowingFunction<float>& getWindow() noexcept { return window; }
+
+    // ļƵͼʵʱƵͬĶӳ
+    juce::Image createImage(int width, int height) const;
+
+private:
+    //==============================================================================
+    class AnalysisJob;
+
+    void jobFinished(bool completed);
+
+    std::unique_ptr<juce::ThreadPool> pool; //һμʱŴ߳
+    juce::dsp::WindowingFunction<float> window;
+
+    juce::HeapBlock<juce::uint8> magnitudes;
+    int numFrames = 0;
+    int hopSize = fftSize;
+    double lengthInSeconds = 0.0;
+
+    std::atomic<int> jobsRemaining { 0 };
+    std::atomic<bool> jobFailed { false };
+    std::atomic<bool> ready { false };
+    std::atomic<bool> failed { false };
+    std::atomic<bool> cancelled { false };
+    juce::int64 startTicks = 0;
+    double framesPerSecond = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FileSpectrogram)
+};
@@ -0,0 +1,118 @@
+#include "JitterBuffer.h"
+
+using namespace juce;
+
+//==============================================================================
+JitterBuffer::JitterBuffer(int capacity, int minimumLatency, int initialLatency, int maximumLatency, int decayIntervalSamples)
+    : fifo(capacity),
+    buffer(2, capacity),
+    minLatency(minimumLatency),
+    maxLatency(jmin(maximumLatency, capacity / 2)),
+    decayInterval(decayIntervalSamples),
+    targetLatency(jlimit(minimumLatency, jmin(maximumLatency, capacity / 2), initialLatency))
+{
+    buffer.clear();
+}
+
+int JitterBuffer::getNumSamplesWritable() const noexcept
+{
+    auto highWaterMark = targetLatency.load() + targetLatency.load() / 2;
+    return jmax(0, jmin(fifo.getFreeSpace(), highWaterMark - fifo.getNumReady()));
+}
+
+void JitterBuffer::write(const AudioSampleBuffer& source, int startSample, int numSamples)
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        auto sourceChannel = jmin(channel, source.getNumChannels() - 1);
+
+        if (size1 > 0)
+            buffer.copyFrom(channel, start1, source, sourceChannel, startSample, size1);
+        if (size2 > 0)
+            buffer.copyFrom(channel, start2, source, sourceChannel, startSample + size1, size2);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+//==============================================================================
+void JitterBuffer::read(const AudioSourceChannelInfo& bufferToFill)
+{
+    auto numSamples = bufferToFill.numSamples;
+    auto ready = fifo.getNumReady();
+    auto target = targetLatency.load();
+
+    // УﵽĿӳ֮ǰʱֱʣ
+    if (buffering)
+    {
+        if (ready < target && !endOfStream.load())
+        {
+            bufferToFill.clearActiveBufferRegion();
+            return;
+        }
+
+        buffering = false;
+    }
+
+    // дظˮλʱߵֻд˳ˮλ̫ʱŶĿӳ
+    if (ready > 2 * target + numSamples)
+    {
+        discard(ready - target);
+        ready = target;
+    }
+
+    if (ready < numSamples)
+    {
+        readFromFifo(bufferToFill, ready);
+        bufferToFill.buffer->clear(bufferToFill.startSample + ready, numSamples - ready);
+
+        if (!endOfStream.load())
+        {
+            // ǷأĿӳٲ»
+            ++numUnderruns;
+            targetLatency = jmin(maxLatency, target + jmax(target / 2, numSamples));
+            buffering = true;
+            samplesSinceUnderrun = 0;
+        }
+        return;
+    }
+
+    readFromFifo(bufferToFill, numSamples);
+
+    // һʱûǷأСĿӳ
+    samplesSinceUnderrun += numSamples;
+    if (samplesSinceUnderrun >= decayInterval)
+    {
+        targetLatency = jmax(minLatency, target - target / 8);
+        samplesSinceUnderrun = 0;
+    }
+}
+
+void JitterBuffer::readFromFifo(const AudioSourceChannelInfo& bufferToFill, int numSamples)
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+
+    for (auto channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+    {
+        auto sourceChannel = jmin(channel, buffer.getNumChannels() - 1);
+
+        if (size1 > 0)
+            bufferToFill.buffer->copyFrom(channel, bufferToFill.startSample, buffer, sourceChannel, start1, size1);
+        if (size2 > 0)
+            bufferToFill.buffer->copyFrom(channel, bufferToFill.startSample + size1, buffer, sourceChannel, start2, size2);
+    }
+
+    fifo.finishedRead(size1 + size2);
+}
+
+void JitterBuffer::discard(int numSamples)
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+    fifo.finishedRead(size1 + size2);
+    numDroppedSamples += size1 + size2;
+}
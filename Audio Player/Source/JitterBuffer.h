@@ -0,0 +1,51 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+using namespace juce;
+//==============================================================================
+
+// /ߵӦ()
+// ȡڻﵽĿӳ֮ǰǷʱĿӳٲ»壬
+// ʱûǷʱ𽥼СĿӳ
+// дֻдĿӳٵ1.5(ˮλ)ʵʱ߻ͣʱд˵ȴ
+// ֻд˲ظˮλĿ2ʱȡ˲Ŷ
+class JitterBuffer
+{
+public:
+    JitterBuffer(int capacity, int minLatency, int initialLatency, int maxLatency, int decayIntervalSamples);
+
+    // ߳
+    int getNumSamplesWritable() const noexcept;  // ˮλдĲΪ0ʱӦȴ
+    void write(const juce::AudioSampleBuffer& source, int startSample, int numSamples);
+    void setEndOfStream() noexcept { endOfStream = true; }
+
+    // Ƶ̣߳ numSamples 
+    void read(const juce::AudioSourceChannelInfo& bufferToFill);
+
+    bool isExhausted() const noexcept { return endOfStream.load() && fifo.getNumReady() == 0; }
+
+    int getFillLevel() const noexcept { return fifo.getNumReady(); }
+    int getTargetLatency() const noexcept { return targetLatency.load(); }
+    int getNumUnderruns() const noexcept { return numUnderruns.load(); }
+    int getNumDroppedSamples() const noexcept { return numDroppedSamples.load(); }
+
+private:
+    //==============================================================================
+    void readFromFifo(const juce::AudioSourceChannelInfo& bufferToFill, int numSamples);
+    void discard(int numSamples);
+
+    juce::AbstractFifo fifo;
+    juce::AudioSampleBuffer buffer;
+
+    const int minLatency, maxLatency, decayInterval;
+    std::atomic<int> targetLatency;
+    std::atomic<int> numUnderruns { 0 };
+    std::atomic<int> numDroppedSamples { 0 };
+    std::atomic<bool> endOfStream { false };
+
+    bool buffering = true;
+    int samplesSinceUnderrun = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JitterBuffer)
+};
@@ -0,0 +1,201 @@
+#include "LatencyHarness.h"
+
+#include <iostream>
+
+using namespace juce;
+
+//==============================================================================
+LatencyHarness::LatencyHarness(const String& commandLine)
+{
+    auto args = StringArray::fromTokens(commandLine, true);
+
+    for (auto& size : StringArray::fromTokens(getOption(args, "--buffer-sizes", "64,128,256,512"), ",", {}))
+        bufferSizes.add(size.getIntValue());
+
+    for (auto& rate : StringArray::fromTokens(getOption(args, "--sample-rates", "44100,48000"), ",", {}))
+        sampleRates.add(rate.getDoubleValue());
+
+    numRuns = jmax(1, getOption(args, "--runs", "10").getIntValue());
+    position = jmax(0.0, getOption(args, "--position", "1.0").getDoubleValue());
+
+    auto path = getOption(args, "--file", {});
+    if (path.isNotEmpty())
+        file = File::getCurrentWorkingDirectory().getChildFile(path);
+}
+
+String LatencyHarness::getOption(const StringArray& args, const String& name, const String& defaultValue)
+{
+    for (auto& arg : args)
+        if (arg.startsWith(name + "="))
+            return arg.fromFirstOccurrenceOf("=", false, false).unquoted();
+
+    return defaultValue;
+}
+
+//==============================================================================
+int LatencyHarness::run()
+{
+    if (file == File())
+        file = createTestFile();
+
+    if (!file.existsAsFile())
+    {
+        std::cerr << "latency test: cannot open " << file.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    MainComponent player;
+    player.deviceManager.addAudioDeviceType(std::make_unique<NullAudioIODeviceType>());
+    player.deviceManager.setCurrentAudioDeviceType(NullAudioIODeviceType::typeName, true);
+
+    // ļʱŻƵ豸֮ȷʹõ豸
+    if (!player.loadFile(file))
+    {
+        std::cerr << "latency test: unsupported file " << file.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    player.deviceManager.setCurrentAudioDeviceType(NullAudioIODeviceType::typeName, true);
+
+    // ӳٰ豸ӳ(һ)ʵ豸ӳٺͬ
+    std::cout << "latencies include the null device's synthetic output latency of one buffer (getOutputLatencyInSamples() == buffer size)" << std::endl;
+    std::cout << "buffer    rate  start ms (mean/max)  seek ms (mean/max)  period ms  jitter ms  max dev ms  callback ms (mean/max)  timeouts" << std::endl;
+
+    auto failed = false;
+
+    for (auto bufferSize : bufferSizes)
+    {
+        for (auto sampleRate : sampleRates)
+        {
+            Result result;
+
+            if (!measure(player, bufferSize, sampleRate, result))
+            {
+                failed = true;
+                continue;
+            }
+
+            auto& cb = result.callbacks;
+            std::cout << String::formatted("%6d %7.0f  %8.2f / %7.2f  %8.2f / %7.2f  %9.3f  %9.3f  %10.3f  %10.3f / %9.3f  %8d",
+                result.bufferSize, result.sampleRate,
+                result.startLatency.getAverage() * 1000.0, result.startLatency.getMaxValue() * 1000.0,
+                result.seekLatency.getAverage() * 1000.0, result.seekLatency.getMaxValue() * 1000.0,
+                cb.meanIntervalSeconds * 1000.0, cb.jitterSeconds * 1000.0, cb.maxDeviationSeconds * 1000.0,
+                cb.meanCallbackSeconds * 1000.0, cb.maxCallbackSeconds * 1000.0,
+                result.timeouts) << std::endl;
+
+            failed = failed || result.timeouts > 0;
+        }
+    }
+
+    return failed ? 1 : 0;
+}
+
+bool LatencyHarness::measure(MainComponent& player, int bufferSize, double sampleRate, Result& result)
+{
+    auto& deviceManager = player.deviceManager;
+
+    AudioDeviceManager::AudioDeviceSetup setup;
+    deviceManager.getAudioDeviceSetup(setup);
+    setup.bufferSize = bufferSize;
+    setup.sampleRate = sampleRate;
+
+    auto error = deviceManager.setAudioDeviceSetup(setup, true);
+    auto* device = dynamic_cast<NullAudioIODevice*>(deviceManager.getCurrentAudioDevice());
+
+    if (error.isNotEmpty() || device == nullptr)
+    {
+        std::cerr << "latency test: cannot open null device: " << error << std::endl;
+        return false;
+    }
+
+    result.bufferSize = device->getCurrentBufferSizeSamples();
+    result.sampleRate = device->getCurrentSampleRate();
+
+    auto bufferMs = jmax(10, roundToInt(4 * result.bufferSize * 1000.0 / result.sampleRate));
+    device->resetCallbackStats();
+
+    for (auto i = 0; i < numRuns; ++i)
+    {
+        // ֹͣ״̬ʼţϵĲŰťͬһ·
+        player.transportSource.setPosition(position);
+        device->armLatencyMeasurement();
+        player.playButtonClicked();
+
+        if (waitForLatency(*device))
+            result.startLatency.addValue(device->getLatencySeconds());
+        else
+            ++result.timeouts;
+
+        waitForState(player, MainComponent::Playing);
+
+        // ھֲżλλ
+        player.transportSource.setPosition(0.0);
+        MessageManager::getInstance()->runDispatchLoopUntil(bufferMs);
+
+        device->armLatencyMeasurement();
+        player.transportSource.setPosition(position);
+
+        if (waitForLatency(*device))
+            result.seekLatency.addValue(device->getLatencySeconds());
+        else
+            ++result.timeouts;
+
+        player.stopButtonClicked();
+        waitForState(player, MainComponent::Stopped);
+    }
+
+    result.callbacks = device->getCallbackStats();
+    return true;
+}
+
+bool LatencyHarness::waitForLatency(NullAudioIODevice& device)
+{
+    auto endTime = Time::getMillisecondCounter() + 1000;
+
+    while (!device.hasLatencyResult())
+    {
+        if (Time::getMillisecondCounter() > endTime)
+            return false;
+
+        MessageManager::getInstance()->runDispatchLoopUntil(1);
+    }
+
+    return true;
+}
+
+void LatencyHarness::waitForState(MainComponent& player, MainComponent::TransportState state)
+{
+    auto endTime = Time::getMillisecondCounter() + 2000;
+
+    while (player.state != state && Time::getMillisecondCounter() < endTime)
+        MessageManager::getInstance()->runDispatchLoopUntil(1);
+}
+
+//==============================================================================
+File LatencyHarness::createTestFile()
+{
+    // ǰ position Ϊ֮3ΪӲ忪ʼҲ֤λĵһͲǾ
+    const auto testSampleRate = 44100.0;
+    auto silentSamples = roundToInt(position * testSampleRate);
+    AudioSampleBuffer buffer(2, silentSamples + (int)(3 * testSampleRate));
+    buffer.clear();
+
+    for (auto i = silentSamples; i < buffer.getNumSamples(); ++i)
+    {
+        auto value = 0.5f * (float)std::cos(MathConstants<double>::twoPi * 440.0 * (i - silentSamples) / testSampleRate);
+        buffer.setSample(0, i, value);
+        buffer.setSample(1, i, value);
+    }
+
+    auto stream = std::make_unique<FileOutputStream>(testFile.getFile());
+    WavAudioFormat wavFormat;
+    std::unique_ptr<AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(), testSampleRate, 2, 16, {}, 0));
+
+    if (writer == nullptr)
+        return {};
+
+    stream.release();
+    writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    return testFile.getFile();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "MainComponent.h"
+#include "NullAudioDevice.h"
+
+using namespace juce;
+//==============================================================================
+
+// ޽ӳ/豸 MainComponent Ƶص
+// У --latency-test [--buffer-sizes=64,128,256,512] [--sample-rates=44100,48000]
+//          [--runs=10] [--file=path --position=seconds]
+// ָļʱһǰ1뾲֮ΪҲʱWAVļ1봦ʼ
+// еĻСͲ豸ʵʹõֵӳٰ豸һӳ
+class LatencyHarness
+{
+public:
+    explicit LatencyHarness(const juce::String& commandLine);
+
+    int run(); //ֵΪ˳
+
+private:
+    //==============================================================================
+    struct Result
+    {
+        juce::StatisticsAccumulator<double> startLatency, seekLatency;
+        NullAudioIODevice::CallbackStats callbacks;
+        int timeouts = 0;
+
+        // 豸ʵʹõãsetAudioDeviceSetup() ܰĻСΪӽĿֵ
+        int bufferSize = 0;
+        double sampleRate = 0.0;
+    };
+
+    bool measure(MainComponent& player, int bufferSize, double sampleRate, Result& result);
+    bool waitForLatency(NullAudioIODevice& device);
+    void waitForState(MainComponent& player, MainComponent::TransportState state);
+
+    juce::File createTestFile();
+    static juce::String getOption(const juce::StringArray& args, const juce::String& name, const juce::String& defaultValue);
+
+    juce::Array<int> bufferSizes;
+    juce::Array<double> sampleRates;
+    int numRuns = 10;
+    juce::File file;
+    double position = 1.0;
+    juce::TemporaryFile testFile { ".wav" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatencyHarness)
+};
@@ -8,6 +8,16 @@
 
 #include <JuceHeader.h>
 #include "MainComponent.h"
+#include "LatencyHarness.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+    // Taken during static initialisation, as close to process start as we can get portably
+    const auto processStartTime = std::chrono::steady_clock::now();
+}
 
 //==============================================================================
 class _201062011Application  : public juce::JUCEApplication
@@ -23,7 +33,58 @@ public:
     {
         // This method is where you should put your application's initialisation code..
 
+        // Headless latency/jitter measurement against a null audio device, no window is created
+        if (commandLine.contains ("--latency-test"))
+        {
+            LatencyHarness harness (commandLine);
+            setApplicationReturnValue (harness.run());
+            quit();
+            return;
+        }
+
+        // Runs the unit tests in the "Audio Player" category, returns non-zero if any failed
+        if (commandLine.contains ("--run-tests"))
+        {
+            juce::UnitTestRunner runner;
+            runner.runTestsInCategory ("Audio Player");
+
+            auto numFailures = 0;
+            for (auto i = 0; i < runner.getNumResults(); ++i)
+                numFailures += runner.getResult (i)->failures;
+
+            setApplicationReturnValue (numFailures > 0 ? 1 : 0);
+            quit();
+            return;
+        }
+
         mainWindow.reset (new MainWindow (getApplicationName()));
+
+        auto* mainComponent = dynamic_cast<MainComponent*> (mainWindow->getContentComponent());
+        jassert (mainComponent != nullptr);
+
+        // Cold-start time to the first painted frame. With --startup-time it is printed and the
+        // app quits, so many instances can be launched in a loop to compare start-up on a shared host
+        auto reportStartupTime = commandLine.contains ("--startup-time");
+        mainComponent->onFirstPaint = [reportStartupTime]
+        {
+            auto ms = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now() - processStartTime).count();
+            DBG ("First frame painted after " << ms << " ms");
+
+            if (reportStartupTime)
+            {
+                std::cout << "startup: first frame painted after " << ms << " ms" << std::endl;
+                JUCEApplication::getInstance()->systemRequestedQuit();
+            }
+        };
+
+        // --eager-startup does all the playback setup before the first frame, as the constructor did
+        // before it was deferred, so both start-up paths can be timed from the same build
+        if (commandLine.contains ("--eager-startup"))
+            mainComponent->prepareForPlayback();
+
+        // e.g. "generator | 201062011 --stream=- --stream-format=s16le --stream-rate=48000"
+        if (auto stream = StreamInputSource::createFromCommandLine (commandLine))
+            mainComponent->openStream (std::move (stream));
     }
 
     void shutdown() override
@@ -4,21 +4,12 @@ using namespace juce;
 
 //==============================================================================
 MainComponent::MainComponent()
-    :forwardFFT(fftOrder),
-    spectrogramImage(Image::RGB, 512, 512, true),
-    state(Stopped),
-    thumbnailCache(5),
-    thumbnail(
-        128,
-        formatManager,
-        thumbnailCache
-    )
+    :state(Stopped)
 {
     setSize(640, 780);
-    formatManager.registerBasicFormats();
-    setAudioChannels(0, 2);
+    // Ƶ豸FFTͼˢ¶ʱڵһδļƵʱųʼ prepareForPlayback()
     transportSource.addChangeListener(this);
-    startTimerHz(60);
+    fileSpectrogram.addChangeListener(this);
     setOpaque(true);
 
     addAndMakeVisible(&openButton);
@@ -90,17 +81,30 @@ MainComponent::MainComponent()
     RoomSize.setValue(0);
     RoomSize.onValueChange = [this]
     {
-        reverbParameters.roomSize = RoomSize.getValue();
-        reverbInstance.setParameters(reverbParameters);
+        guiParameters.roomSize = (float)RoomSize.getValue();
+        parameterSnapshot.publish(guiParameters);
     };
 
     addAndMakeVisible(RoomSize);
 
+    addAndMakeVisible(&layerButton);
+    layerButton.setButtonText("Add Layers...");
+    layerButton.onClick = [this] { layerButtonClicked(); };
+
+    addAndMakeVisible(&streamLabel);
+    streamLabel.setText("", juce::dontSendNotification);
+
+    addAndMakeVisible(&fileSpectrogramLabel);
+    fileSpectrogramLabel.setText("Spectrogram: --", juce::dontSendNotification);
+
     nowTime = 0.0f;
 }
 
 MainComponent::~MainComponent()
 {
+    fileSpectrogram.removeChangeListener(this);
+    fileSpectrogram.cancel();
+    transportSource.setSource(nullptr);
     shutdownAudio();
 }
 
@@ -108,21 +112,36 @@ MainComponent::~MainComponent()
 void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
 {
     reverbInstance.setSampleRate(sampleRate);
+    reverbDryBuffer.setSize(2, samplesPerBlockExpected);
     transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    voiceMixer.prepareToPlay(samplesPerBlockExpected, sampleRate);
 }
 
 void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
 {
 
-    if (readerSource.get() == nullptr)
+    auto hasSource = readerSource.get() != nullptr || streamSource.get() != nullptr;
+
+    if (!hasSource && voiceMixer.getNumVoices() == 0)
     {
         bufferToFill.clearActiveBufferRegion();
         return;
     }
 
-    transportSource.getNextAudioBlock(bufferToFill);
+    if (!hasSource)
+        bufferToFill.clearActiveBufferRegion();
+    else
+        transportSource.getNextAudioBlock(bufferToFill);
+
+    //ͬʱŵļ
+    voiceMixer.addNextAudioBlock(bufferToFill);
         ScopedNoDenormals noDenormals;
 
+    //ÿȡһβգ仯ڿƽ
+    const auto& parameters = parameterSnapshot.acquire();
+    auto targetGain = Decibels::decibelsToGain(parameters.volumeDb);
+    auto gainStep = (targetGain - currentGain) / (float)bufferToFill.numSamples;
+
     for (auto channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
     {
         auto* inBuffer = bufferToFill.buffer->getReadPointer(channel, bufferToFill.startSample);
@@ -132,28 +151,85 @@ void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& buffer
         for (auto sample = 0; sample < bufferToFill.numSamples; ++sample)
         {
             pushNextSampleIntoFifo(channelData[sample]);
-            outBuffer[sample] = inBuffer[sample] * pow(10, ((float)volumeSlider.getValue() / 20.0));
+            outBuffer[sample] = inBuffer[sample] * (currentGain + gainStep * (float)sample);
            
          }
-        if(ReverbOpen)
-        { reverbInstance.processStereo(bufferToFill.buffer->getWritePointer(0),bufferToFill.buffer->getWritePointer(1), bufferToFill.buffer->getNumSamples());
     }
+    currentGain = targetGain;
+
+    processReverb(bufferToFill, parameters);
 }
-         
 
-  
+void MainComponent::processReverb(const juce::AudioSourceChannelInfo& bufferToFill, const DspParameters& parameters)
+{
+    auto* buffer = bufferToFill.buffer;
+    auto start = bufferToFill.startSample;
+    auto numSamples = bufferToFill.numSamples;
+
+    if (buffer->getNumChannels() < 2)
+        return;
+
+    // ReverbڲԷСȲƽֻڱ仯ʱ
+    if (parameters.roomSize != reverbParameters.roomSize)
+    {
+        reverbParameters.roomSize = parameters.roomSize;
+        reverbInstance.setParameters(reverbParameters);
+    }
+
+    if (parameters.reverbOn == reverbActive)
+    {
+        if (reverbActive)
+            reverbInstance.processStereo(buffer->getWritePointer(0, start), buffer->getWritePointer(1, start), numSamples);
+        return;
+    }
 
+    // ػʱһڽ浭ⱬ
+    // 豸ĿԤڴʱ reverbDryBuffer ĳȷֶΣÿʹϽһ
+    if (parameters.reverbOn)
+        reverbInstance.reset();
+
+    auto wetStart = reverbActive ? 1.0f : 0.0f;
+    auto wetEnd = 1.0f - wetStart;
+    auto chunkSize = reverbDryBuffer.getNumSamples();
+
+    for (auto offset = 0; offset < numSamples && chunkSize > 0; offset += chunkSize)
+    {
+        auto chunkStart = start + offset;
+        auto chunkLength = jmin(chunkSize, numSamples - offset);
+        auto wetFrom = wetStart + (wetEnd - wetStart) * (float)offset / (float)numSamples;
+        auto wetTo = wetStart + (wetEnd - wetStart) * (float)(offset + chunkLength) / (float)numSamples;
+
+        for (auto channel = 0; channel < 2; ++channel)
+            reverbDryBuffer.copyFrom(channel, 0, *buffer, channel, chunkStart, chunkLength);
+
+        reverbInstance.processStereo(buffer->getWritePointer(0, chunkStart), buffer->getWritePointer(1, chunkStart), chunkLength);
+
+        for (auto channel = 0; channel < 2; ++channel)
+        {
+            buffer->applyGainRamp(channel, chunkStart, chunkLength, wetFrom, wetTo);
+            buffer->addFromWithRamp(channel, chunkStart, reverbDryBuffer.getReadPointer(channel), chunkLength, 1.0f - wetFrom, 1.0f - wetTo);
+        }
+    }
 
+    reverbActive = parameters.reverbOn;
 }
 
 void MainComponent::releaseResources()
 {
     transportSource.releaseResources();
+    voiceMixer.releaseResources();
 }
 
 //==============================================================================
 void MainComponent::paint(juce::Graphics& g)
 {
+    if (onFirstPaint != nullptr)
+    {
+        auto callback = std::move(onFirstPaint);
+        onFirstPaint = nullptr;
+        callback();
+    }
+
     g.setColour(juce::Colours::black);
     g.fillRect(0, 0, getWidth(), getHeight());
     if (totalTime == 0.0f) {
@@ -163,17 +239,30 @@ void MainComponent::paint(juce::Graphics& g)
     g.setColour(juce::Colours::black);
     g.fillRect(area);
     g.setColour(juce::Colours::white);
-    g.fillRect(10, 160, int((getWidth() - 20) * (nowTime / totalTime)), 10);
+    // Ƶûܳȣʾ
+    if (streamSource == nullptr)
+        g.fillRect(10, 160, int((getWidth() - 20) * (nowTime / totalTime)), 10);
 
     g.setOpacity(1.0f); //͸
     juce::Rectangle<int> FFT(10, 520, getWidth() - 20, 100);
     g.drawImage(spectrogramImage, FFT.toFloat());
 
+    //ļƵԼǰλ
+    auto fileSpectrogramBounds = getFileSpectrogramBounds();
+    if (fileSpectrogramImage.isValid())
+    {
+        g.drawImage(fileSpectrogramImage, fileSpectrogramBounds.toFloat());
+        g.setColour(juce::Colours::white);
+        auto x = fileSpectrogramBounds.getX() + int(fileSpectrogramBounds.getWidth() * (nowTime / totalTime));
+        g.drawVerticalLine(x, (float)fileSpectrogramBounds.getY(), (float)fileSpectrogramBounds.getBottom());
+    }
+
     juce::Rectangle<int> thumbnailBounds(10, 380, getWidth() - 20, 100);
     g.setColour(juce::Colours::white);
     g.fillRect(thumbnailBounds);
     g.setColour(juce::Colours::blue);
-    thumbnail.drawChannels(g, thumbnailBounds, 0, thumbnail.getTotalLength(), 5);
+    if (thumbnail != nullptr)
+        thumbnail->drawChannels(g, thumbnailBounds, 0, thumbnail->getTotalLength(), 5);
 
 
 }
@@ -194,6 +283,30 @@ void MainComponent::resized()
     Image2.setBounds(10, 500, 40, 20);
     RoomSize.setBounds(Left, 700 , getWidth() - Left - 10, 20);
     ReverbButton.setBounds(12, 730, 100, 20);
+    fileSpectrogramLabel.setBounds(10, 325, getWidth() - 20, 20);
+    layerButton.setBounds(getWidth() / 2 + 5, 730, getWidth() / 2 - 15, 20);
+    streamLabel.setBounds(10, 105, getWidth() - 20, 20);
+}
+
+void MainComponent::mouseDown(const juce::MouseEvent& event)
+{
+    scrubFileSpectrogram(event.getPosition());
+}
+
+void MainComponent::mouseDrag(const juce::MouseEvent& event)
+{
+    scrubFileSpectrogram(event.getPosition());
+}
+
+void MainComponent::scrubFileSpectrogram(juce::Point<int> position)
+{
+    auto bounds = getFileSpectrogramBounds();
+    if (!fileSpectrogramImage.isValid() || streamSource != nullptr || !bounds.contains(position))
+        return;
+
+    auto proportion = (position.x - bounds.getX()) / (double)bounds.getWidth();
+    transportSource.setPosition(proportion * transportSource.getLengthInSeconds());
+    updateTime();
 }
 
 
@@ -203,24 +316,113 @@ void MainComponent::openButtonClicked()
     juce::FileChooser chooser("Select a Wave file to play...", {}, "*.wav,*.aac,*.mp3");
 
     if (chooser.browseForFileToOpen())
+        loadFile(chooser.getResult());
+}
+
+void MainComponent::layerButtonClicked()
+{
+    juce::FileChooser chooser("Select files to play on top...", {}, "*.wav,*.aac,*.mp3");
+
+    if (chooser.browseForMultipleFilesToOpen())
+    {
+        prepareForPlayback();
+
+        for (auto& file : chooser.getResults())
+            voiceMixer.addVoice(formatManager.createReaderFor(file), 0.5f);
+    }
+}
+
+bool MainComponent::loadFile(const juce::File& file)
+{
+    prepareForPlayback();
+
+    auto* reader = formatManager.createReaderFor(file);
+
+    if (reader != nullptr)
     {
-        auto file = chooser.getResult();
-        auto* reader = formatManager.createReaderFor(file);
+        std::unique_ptr<juce::AudioFormatReaderSource> newSource(new juce::AudioFormatReaderSource(reader, true));
+        transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate);
+        playButton.setEnabled(true);
+        readerSource.reset(newSource.release());
 
-        if (reader != nullptr)
+        if (streamSource != nullptr)
         {
-            std::unique_ptr<juce::AudioFormatReaderSource> newSource(new juce::AudioFormatReaderSource(reader, true));
-            transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate);
-            playButton.setEnabled(true);
-            readerSource.reset(newSource.release());
+            streamSource->removeChangeListener(this);
+            streamSource.reset();
+            streamLabel.setText("", dontSendNotification);
         }
-        nowTime = transportSource.getCurrentPosition();
-        totalTime = transportSource.getLengthInSeconds();
-        nameButton.setButtonText(file.getFileName());
-        nowTimeLabel.setText(_timeFormat(nowTime), dontSendNotification);
-        totalTimeLabel.setText(_timeFormat(totalTime), dontSendNotification);
-        thumbnail.setSource(new juce::FileInputSource(file));
+
+        fileSpectrogramImage = Image();
+        fileSpectrogramLabel.setText("Spectrogram: analysing...", dontSendNotification);
+        fileSpectrogram.analyse(file, formatManager);
+    }
+    nowTime = transportSource.getCurrentPosition();
+    totalTime = transportSource.getLengthInSeconds();
+    nameButton.setButtonText(file.getFileName());
+    nowTimeLabel.setText(_timeFormat(nowTime), dontSendNotification);
+    totalTimeLabel.setText(_timeFormat(totalTime), dontSendNotification);
+    thumbnail->setSource(new juce::FileInputSource(file));
+
+    return reader != nullptr;
+}
+
+void MainComponent::openStream(std::unique_ptr<StreamInputSource> stream)
+{
+    if (stream == nullptr)
+        return;
+
+    prepareForPlayback();
+
+    transportSource.setSource(nullptr);
+    readerSource.reset();
+    playButton.setEnabled(false);
+
+    if (streamSource != nullptr)
+        streamSource->removeChangeListener(this);
+
+    // һļƵײٶӦǰŵݣƵҲܶλ
+    fileSpectrogram.cancel();
+    fileSpectrogramImage = Image();
+    fileSpectrogramLabel.setText("Spectrogram: --", dontSendNotification);
+    totalTime = 0.0;
+
+    // ʽȷ֮(changeListenerCallback)Ž transportSource
+    streamSource = std::move(stream);
+    streamSource->addChangeListener(this);
+    streamSource->start();
+
+    nameButton.setButtonText(streamSource->getName());
+    nowTimeLabel.setText("--:--.---", dontSendNotification);
+    totalTimeLabel.setText("--:--.---", dontSendNotification);
+    streamLabel.setText("Stream: waiting for data...", dontSendNotification);
+    thumbnail->clear();
+}
+
+void MainComponent::prepareForPlayback()
+{
+    if (formatManager.getNumKnownFormats() == 0)
+        formatManager.registerBasicFormats();
+
+    if (forwardFFT == nullptr)
+    {
+        forwardFFT.reset(new dsp::FFT(fftOrder));
+        spectrogramImage = Image(Image::RGB, 512, 512, true);
     }
+
+    if (thumbnail == nullptr)
+    {
+        thumbnailCache.reset(new AudioThumbnailCache(5));
+        thumbnail.reset(new AudioThumbnail(128, formatManager, *thumbnailCache));
+    }
+
+    if (!audioOpened)
+    {
+        setAudioChannels(0, 2);
+        audioOpened = true;
+    }
+
+    if (!isTimerRunning())
+        startTimerHz(60);
 }
 
 void MainComponent::changeState(TransportState newState)
@@ -264,7 +466,14 @@ void MainComponent::changeState(TransportState newState)
     }
 }
 
-void MainComponent::sliderValueChanged(juce::Slider* slider){}
+void MainComponent::sliderValueChanged(juce::Slider* slider)
+{
+    if (slider == &volumeSlider)
+    {
+        guiParameters.volumeDb = (float)volumeSlider.getValue();
+        parameterSnapshot.publish(guiParameters);
+    }
+}
 
 
 void MainComponent::changeListenerCallback(ChangeBroadcaster* source)
@@ -278,6 +487,33 @@ void MainComponent::changeListenerCallback(ChangeBroadcaster* source)
         else if (Pausing == state)
             changeState(Paused);
     }
+    else if (streamSource != nullptr && source == streamSource.get())
+    {
+        if (streamSource->getLastError().isNotEmpty())
+            streamLabel.setText("Stream: " + streamSource->getLastError(), dontSendNotification);
+        else if (streamSource->isReady())
+        {
+            transportSource.setSource(streamSource.get(), 0, nullptr, streamSource->getSampleRate());
+            totalTime = 0.0;
+            playButton.setEnabled(true);
+        }
+    }
+    else if (source == &fileSpectrogram)
+    {
+        if (fileSpectrogram.isReady())
+        {
+            fileSpectrogramImage = fileSpectrogram.createImage(512, 128);
+            fileSpectrogramLabel.setText("Spectrogram: " + juce::String(fileSpectrogram.getNumFrames()) + " frames, "
+                + juce::String(fileSpectrogram.getFramesPerSecond(), 0) + " frames/s, "
+                + juce::String(fileSpectrogram.getMemoryBytes() / 1024) + " KB", dontSendNotification);
+            repaint();
+        }
+        else if (fileSpectrogram.hasFailed())
+        {
+            // ļ޷һFFTȻ
+            fileSpectrogramLabel.setText("Spectrogram: unavailable", dontSendNotification);
+        }
+    }
 }
 
 void MainComponent::buttonClicked(Button*)
@@ -320,14 +556,15 @@ void  MainComponent::forwardButtonClicked()
 
 void MainComponent::ReverbButtonClicked()
 {
-    if (ReverbOpen == false)
+    if (guiParameters.reverbOn == false)
     {
-        ReverbOpen = true;
+        guiParameters.reverbOn = true;
     }
-    else if (ReverbOpen == true)
+    else if (guiParameters.reverbOn == true)
     {
-        ReverbOpen = false;
+        guiParameters.reverbOn = false;
     }
+    parameterSnapshot.publish(guiParameters);
 }
 
 
@@ -348,6 +585,16 @@ void MainComponent::updateTime()
 void  MainComponent::timerCallback()
 {
     updateTime();
+    voiceMixer.removeFinishedVoices();
+
+    if (streamSource != nullptr)
+    {
+        if (auto* jitterBuffer = streamSource->getJitterBuffer())
+            streamLabel.setText("Stream: fill " + juce::String(jitterBuffer->getFillLevel())
+                + " / target " + juce::String(jitterBuffer->getTargetLatency()) + " samples, underruns "
+                + juce::String(jitterBuffer->getNumUnderruns()) + ", dropped "
+                + juce::String(jitterBuffer->getNumDroppedSamples()), dontSendNotification);
+    }
 }
 
 //-------------------------------------------------------------------------------
@@ -378,8 +625,11 @@ void MainComponent::drawNextLineOfSpectrogram()
     //ƶǰͼƬ1أÿμFFTʹ1رʾ
     spectrogramImage.moveImageSection(0, 0, 1, 0, rightHandEdge, imageHeight);
 
+    //ļƵʹͬĴ
+    fileSpectrogram.getWindow().multiplyWithWindowingTable(fftData, fftSize);
+
     //FFTݻͬʱʵ鲿
-    forwardFFT.performFrequencyOnlyForwardTransform(fftData);
+    forwardFFT->performFrequencyOnlyForwardTransform(fftData);
 
     //ȡʱʹ߽
     auto maxLevel = FloatVectorOperations::findMinAndMax(fftData, fftSize / 2);
@@ -394,4 +644,6 @@ void MainComponent::drawNextLineOfSpectrogram()
         auto level = jmap(fftData[fftDataIndex], 0.0f, jmax(maxLevel.getEnd(), 1e-5f), 0.0f, 1.0f);
 
         //ƵǰƵ㣬ʹɫůʾǿ
-        spectrogramImage.setPixelAt(rightHandEdge, y, Colour::fromHSV(level, 1.0f, level, 1.0
\ No newline at end of file
+        spectrogramImage.setPixelAt(rightHandEdge, y, Colour::fromHSV(level, 1.0f, level, 1.0f));
+    }
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FileSpectrogram.h"
+#include "VoiceMixer.h"
+#include "StreamInputSource.h"
+#include "ParameterSnapshot.h"
 
 using namespace juce;
 //==============================================================================
@@ -21,10 +25,19 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
 
+    bool loadFile(const juce::File& file);  // Ƶļɹtrue
+    void openStream(std::unique_ptr<StreamInputSource> stream);  // Թܵ׼Ƶ
+
+    void prepareForPlayback();  // һβǰʼƵ豸ƵףظӰ
+    std::function<void()> onFirstPaint;  // һλʱһΣڲʱ
+
+    void mouseDown(const juce::MouseEvent& event) override;
+    void mouseDrag(const juce::MouseEvent& event) override;
+
     enum
     {
-        fftOrder = 10,
-        fftSize = 1 << fftOrder
+        fftOrder = FileSpectrogram::fftOrder,
+        fftSize = FileSpectrogram::fftSize
     };
 
     Reverb reverbInstance;
@@ -33,7 +46,7 @@ public:
 private:
     //==============================================================================
     //JUCEԴFFT
-    dsp::FFT forwardFFT;
+    std::unique_ptr<dsp::FFT> forwardFFT;
     // չʾƵ׵ͼƬҪעͼƬͼƬؼҪʹJUCE GraphĻƴͼƬ
     Image spectrogramImage;
 
@@ -43,10 +56,35 @@ private:
     int fifoIndex = 0; //FFT
     bool nextFFTBlockReady = false; //ǷһFFTı־λֹFFTµˢ
 
+    //ļƵףļʱ̨м
+    FileSpectrogram fileSpectrogram;
+    Image fileSpectrogramImage;
+
+    //ļͬʱŵļ
+    VoiceMixer voiceMixer;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent) 
 
+    friend class LatencyHarness;
+
     double sampleRate = 0.0;
-    bool ReverbOpen = false;
+    bool audioOpened = false;
+
+    //DSP޸ĺ巢Ƶ̣߳ԺµЧҲ
+    struct DspParameters
+    {
+        float volumeDb = 0.0f;
+        bool reverbOn = false;
+        float roomSize = 0.0f;
+    };
+
+    DspParameters guiParameters;  //ֻϢ߳ʹ
+    ParameterSnapshot<DspParameters> parameterSnapshot;
+
+    //ֻƵ߳ʹ
+    float currentGain = 1.0f;
+    bool reverbActive = false;
+    juce::AudioSampleBuffer reverbDryBuffer;
 
     juce::TextButton openButton;
     juce::TextButton playButton;
@@ -65,6 +103,9 @@ private:
     juce::Slider RoomSize;
     juce::Label  RomeSizeLabel;
     juce::ToggleButton ReverbButton;
+    juce::Label  fileSpectrogramLabel;
+    juce::TextButton layerButton;
+    juce::Label  streamLabel;
 
     double nowTime;
     double totalTime;
@@ -82,6 +123,7 @@ private:
 
     juce::AudioFormatManager formatManager;
     std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+    std::unique_ptr<StreamInputSource> streamSource;
     juce::AudioTransportSource transportSource;
     TransportState state;
 
@@ -91,8 +133,9 @@ private:
 
     int fileBufferPosition;
 
-    juce::AudioThumbnailCache thumbnailCache;
-    juce::AudioThumbnail thumbnail;
+    // Լ̣߳һδļʱŴ
+    std::unique_ptr<juce::AudioThumbnailCache> thumbnailCache;
+    std::unique_ptr<juce::AudioThumbnail> thumbnail;
 
 
     void openButtonClicked();
@@ -109,6 +152,8 @@ private:
 
     void ReverbButtonClicked();
 
+    void layerButtonClicked();
+
     void updateTime();
 
  
@@ -124,6 +169,12 @@ private:
 
     void drawNextLineOfSpectrogram();  // FFTݣFFTƵ
 
+    void processReverb(const juce::AudioSourceChannelInfo& bufferToFill, const DspParameters& parameters);  // մ
+
+    juce::Rectangle<int> getFileSpectrogramBounds() const { return { 10, 240, getWidth() - 20, 50 }; }
+
+    void scrubFileSpectrogram(juce::Point<int> position);  // ļƵϵ϶λ
+
     juce::String _numberFormat(int number, int minWidth)
     {
         juce::String result = juce::String(number);
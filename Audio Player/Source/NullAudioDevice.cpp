@@ -0,0 +1,195 @@
+#include "NullAudioDevice.h"
+
+using namespace juce;
+
+//==============================================================================
+NullAudioIODevice::NullAudioIODevice(const String& deviceName, const String& deviceTypeName)
+    : AudioIODevice(deviceName, deviceTypeName),
+    Thread("Null Audio Device")
+{
+    callbackStartTicks.malloc(maxRecordedCallbacks);
+    callbackDurationTicks.malloc(maxRecordedCallbacks);
+}
+
+NullAudioIODevice::~NullAudioIODevice()
+{
+    close();
+}
+
+String NullAudioIODevice::open(const BigInteger&, const BigInteger& outputChannels,
+    double newSampleRate, int bufferSizeSamples)
+{
+    close();
+
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    bufferSize = bufferSizeSamples > 0 ? bufferSizeSamples : getDefaultBufferSize();
+
+    activeOutputChannels = outputChannels;
+    activeOutputChannels.setRange(2, activeOutputChannels.getHighestBit() + 1, false);
+    outputBuffer.setSize(2, bufferSize);
+
+    opened = true;
+    return {};
+}
+
+void NullAudioIODevice::close()
+{
+    stop();
+    opened = false;
+}
+
+void NullAudioIODevice::start(AudioIODeviceCallback* callback)
+{
+    if (!opened || callback == nullptr)
+        return;
+
+    stop();
+
+    callback->audioDeviceAboutToStart(this);
+
+    {
+        const ScopedLock sl(callbackLock);
+        currentCallback = callback;
+        numRecordedCallbacks = 0;
+    }
+
+    startThread(Thread::realtimeAudioPriority);
+}
+
+void NullAudioIODevice::stop()
+{
+    stopThread(2000);
+
+    AudioIODeviceCallback* lastCallback = nullptr;
+    {
+        const ScopedLock sl(callbackLock);
+        std::swap(lastCallback, currentCallback);
+    }
+
+    if (lastCallback != nullptr)
+        lastCallback->audioDeviceStopped();
+}
+
+//==============================================================================
+void NullAudioIODevice::armLatencyMeasurement()
+{
+    lastLatencySeconds = -1.0;
+    commandTicks = Time::getHighResolutionTicks();
+}
+
+void NullAudioIODevice::resetCallbackStats()
+{
+    const ScopedLock sl(callbackLock);
+    numRecordedCallbacks = 0;
+}
+
+NullAudioIODevice::CallbackStats NullAudioIODevice::getCallbackStats() const
+{
+    const ScopedLock sl(callbackLock);
+
+    CallbackStats stats;
+    stats.numCallbacks = numRecordedCallbacks;
+
+    if (numRecordedCallbacks < 2)
+        return stats;
+
+    auto period = bufferSize / sampleRate;
+    auto numIntervals = numRecordedCallbacks - 1;
+    double sum = 0.0, sumOfSquares = 0.0;
+
+    for (auto i = 0; i < numIntervals; ++i)
+    {
+        auto interval = Time::highResolutionTicksToSeconds(callbackStartTicks[i + 1] - callbackStartTicks[i]);
+        sum += interval;
+        sumOfSquares += interval * interval;
+        stats.maxDeviationSeconds = jmax(stats.maxDeviationSeconds, std::abs(interval - period));
+    }
+
+    stats.meanIntervalSeconds = sum / numIntervals;
+    stats.jitterSeconds = std::sqrt(jmax(0.0, sumOfSquares / numIntervals - stats.meanIntervalSeconds * stats.meanIntervalSeconds));
+
+    for (auto i = 0; i < numRecordedCallbacks; ++i)
+    {
+        auto duration = Time::highResolutionTicksToSeconds(callbackDurationTicks[i]);
+        stats.meanCallbackSeconds += duration / numRecordedCallbacks;
+        stats.maxCallbackSeconds = jmax(stats.maxCallbackSeconds, duration);
+    }
+
+    return stats;
+}
+
+//==============================================================================
+void NullAudioIODevice::run()
+{
+    auto periodTicks = (int64)(Time::getHighResolutionTicksPerSecond() * bufferSize / sampleRate);
+    auto nextTicks = Time::getHighResolutionTicks();
+
+    while (!threadShouldExit())
+    {
+        // ȴߣ1óCPUȴӽ
+        auto remainingMs = Time::highResolutionTicksToSeconds(nextTicks - Time::getHighResolutionTicks()) * 1000.0;
+        if (remainingMs > 2.0)
+            Thread::sleep((int)remainingMs - 1);
+
+        while (Time::getHighResolutionTicks() < nextTicks && !threadShouldExit())
+            Thread::yield();
+
+        nextTicks += periodTicks;
+
+        const ScopedLock sl(callbackLock);
+
+        if (currentCallback == nullptr)
+            continue;
+
+        auto startTicks = Time::getHighResolutionTicks();
+        auto armedTicks = commandTicks.load();
+
+        outputBuffer.clear();
+        currentCallback->audioDeviceIOCallback(nullptr, 0, outputBuffer.getArrayOfWritePointers(),
+            outputBuffer.getNumChannels(), bufferSize);
+
+        auto endTicks = Time::getHighResolutionTicks();
+
+        if (numRecordedCallbacks < maxRecordedCallbacks)
+        {
+            callbackStartTicks[numRecordedCallbacks] = startTicks;
+            callbackDurationTicks[numRecordedCallbacks] = endTicks - startTicks;
+            ++numRecordedCallbacks;
+        }
+
+        if (armedTicks == 0)
+            continue;
+
+        // һǾĲʱ = صʼʱ + ӳ + ڻеλ
+        for (auto sample = 0; sample < bufferSize; ++sample)
+        {
+            if (std::abs(outputBuffer.getSample(0, sample)) > 1.0e-3f
+                || std::abs(outputBuffer.getSample(1, sample)) > 1.0e-3f)
+            {
+                lastLatencySeconds = Time::highResolutionTicksToSeconds(startTicks - armedTicks)
+                    + (getOutputLatencyInSamples() + sample) / sampleRate;
+                commandTicks = 0;
+                break;
+            }
+        }
+    }
+}
+
+//==============================================================================
+StringArray NullAudioIODeviceType::getDeviceNames(bool wantInputNames) const
+{
+    if (wantInputNames)
+        return {};
+
+    return { "Null Output" };
+}
+
+int NullAudioIODeviceType::getIndexOfDevice(AudioIODevice* device, bool asInput) const
+{
+    return (device != nullptr && !asInput) ? 0 : -1;
+}
+
+AudioIODevice* NullAudioIODeviceType::createDevice(const String& outputDeviceName, const String&)
+{
+    return new NullAudioIODevice(outputDeviceName.isNotEmpty() ? outputDeviceName : "Null Output", getTypeName());
+}
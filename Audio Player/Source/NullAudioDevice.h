@@ -0,0 +1,104 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+using namespace juce;
+//==============================================================================
+
+// κӲ豸ų̰́߳ bufferSize / sampleRate ڵƵص
+// ûLinuxϲӳٺͻص
+class NullAudioIODevice : public juce::AudioIODevice, private juce::Thread
+{
+public:
+    NullAudioIODevice(const juce::String& deviceName, const juce::String& deviceTypeName);
+    ~NullAudioIODevice() override;
+
+    //==============================================================================
+    juce::StringArray getOutputChannelNames() override { return { "Left", "Right" }; }
+    juce::StringArray getInputChannelNames() override { return {}; }
+    juce::Array<double> getAvailableSampleRates() override { return { 22050.0, 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 }; }
+    juce::Array<int> getAvailableBufferSizes() override { return { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 }; }
+    int getDefaultBufferSize() override { return 512; }
+
+    juce::String open(const juce::BigInteger& inputChannels, const juce::BigInteger& outputChannels,
+        double sampleRate, int bufferSizeSamples) override;
+    void close() override;
+    bool isOpen() override { return opened; }
+
+    void start(juce::AudioIODeviceCallback* callback) override;
+    void stop() override;
+    bool isPlaying() override { return isThreadRunning(); }
+
+    juce::String getLastError() override { return {}; }
+    int getCurrentBufferSizeSamples() override { return bufferSize; }
+    double getCurrentSampleRate() override { return sampleRate; }
+    int getCurrentBitDepth() override { return 32; }
+    juce::BigInteger getActiveOutputChannels() const override { return activeOutputChannels; }
+    juce::BigInteger getActiveInputChannels() const override { return {}; }
+
+    // ģ˫壺صдһڲűš
+    int getOutputLatencyInSamples() override { return bufferSize; }
+    int getInputLatencyInSamples() override { return 0; }
+
+    //==============================================================================
+    // ڷ/λ֮ǰã¼ʱ䣬֮һǾΪ
+    void armLatencyMeasurement();
+    bool hasLatencyResult() const noexcept { return lastLatencySeconds.load() >= 0.0; }
+    double getLatencySeconds() const noexcept { return lastLatencySeconds.load(); }
+
+    struct CallbackStats
+    {
+        int numCallbacks = 0;
+        double meanIntervalSeconds = 0.0;
+        double jitterSeconds = 0.0; //صı׼
+        double maxDeviationSeconds = 0.0; //صڵƫ
+        double meanCallbackSeconds = 0.0;
+        double maxCallbackSeconds = 0.0;
+    };
+
+    void resetCallbackStats();
+    CallbackStats getCallbackStats() const;
+
+private:
+    //==============================================================================
+    void run() override;
+
+    enum { maxRecordedCallbacks = 1 << 16 };
+
+    double sampleRate = 44100.0;
+    int bufferSize = 512;
+    bool opened = false;
+    juce::BigInteger activeOutputChannels;
+    juce::AudioSampleBuffer outputBuffer;
+
+    juce::CriticalSection callbackLock;
+    juce::AudioIODeviceCallback* currentCallback = nullptr;
+
+    // صʼʱͺʱλΪ high resolution ticks
+    juce::HeapBlock<juce::int64> callbackStartTicks, callbackDurationTicks;
+    int numRecordedCallbacks = 0;
+
+    std::atomic<juce::int64> commandTicks { 0 };
+    std::atomic<double> lastLatencySeconds { -1.0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NullAudioIODevice)
+};
+
+//==============================================================================
+class NullAudioIODeviceType : public juce::AudioIODeviceType
+{
+public:
+    static constexpr const char* typeName = "Null";
+
+    NullAudioIODeviceType() : AudioIODeviceType(typeName) {}
+
+    void scanForDevices() override {}
+    juce::StringArray getDeviceNames(bool wantInputNames) const override;
+    int getDefaultDeviceIndex(bool forInput) const override { return forInput ? -1 : 0; }
+    int getIndexOfDevice(juce::AudioIODevice* device, bool asInput) const override;
+    bool hasSeparateInputsAndOutputs() const override { return false; }
+    juce::AudioIODevice* createDevice(const juce::String& outputDeviceName, const juce::String& inputDeviceName) override;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NullAudioIODeviceType)
+};
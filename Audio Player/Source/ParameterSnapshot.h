@@ -0,0 +1,48 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+using namespace juce;
+//==============================================================================
+
+// Ĳ()Ϣ̷߳һƵ߳ÿȡһµ
+// д˺Ͷȡ˸ӵһмĻͨԭӽݣдһ
+// ֻһд̺߳һȡ߳
+template <typename Parameters>
+class ParameterSnapshot
+{
+public:
+    static_assert(std::is_trivially_copyable<Parameters>::value, "parameters are copied between threads");
+
+    explicit ParameterSnapshot(const Parameters& initial = {})
+    {
+        for (auto& buffer : buffers)
+            buffer = initial;
+    }
+
+    // Ϣ̣߳һĲ
+    void publish(const Parameters& parameters) noexcept
+    {
+        buffers[writeIndex] = parameters;
+        writeIndex = middle.exchange(writeIndex | newDataFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Ƶ̣߳ÿһΣصһε֮ǰֲ
+    const Parameters& acquire() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & newDataFlag) != 0)
+            readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+
+        return buffers[readIndex];
+    }
+
+private:
+    enum { indexMask = 3, newDataFlag = 4 };
+
+    Parameters buffers[3];
+    int writeIndex = 0;
+    std::atomic<int> middle { 1 };
+    int readIndex = 2;
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterSnapshot)
+};
@@ -0,0 +1,382 @@
+#include "StreamInputSource.h"
+
+#if JUCE_WINDOWS
+ #include <iostream>
+#else
+ #include <errno.h>
+ #include <fcntl.h>
+ #include <poll.h>
+ #include <unistd.h>
+#endif
+
+using namespace juce;
+
+#if ! JUCE_WINDOWS
+namespace
+{
+    //==============================================================================
+    // Էʽ򿪹ܵȡǰpollȴݣÿ50msһ߳ǷҪ˳
+    // FIFO(д˻û)ͣʱһֱstopThread() ߳
+    class PipeInputStream : public InputStream
+    {
+    public:
+        PipeInputStream(const String& path, const Thread& readerThread)
+            : thread(readerThread),
+            isStandardInput(path == "-")
+        {
+            if (isStandardInput)
+                fd = STDIN_FILENO;
+            else
+                fd = ::open(File::getCurrentWorkingDirectory().getChildFile(path).getFullPathName().toRawUTF8(),
+                    O_RDONLY | O_NONBLOCK);
+        }
+
+        ~PipeInputStream() override
+        {
+            if (fd >= 0 && !isStandardInput)
+                ::close(fd);
+        }
+
+        bool openedOk() const noexcept { return fd >= 0; }
+
+        // صǰѾݣ1ֽڣ߳Ҫ˳ʱ0
+        int readAvailable(void* destBuffer, int maxBytesToRead)
+        {
+            while (!finished && waitUntilReadable())
+            {
+                auto result = ::read(fd, destBuffer, (size_t)maxBytesToRead);
+
+                if (result > 0)
+                {
+                    hasReceivedData = true;
+                    position += result;
+                    return (int)result;
+                }
+
+                if (result < 0 && (errno == EAGAIN || errno == EINTR))
+                    continue;
+
+                // еϵͳд˴֮ǰͱFIFOѹҶϣյ֮ǰEOFֻʾûд
+                if (result == 0 && !isStandardInput && !hasReceivedData)
+                {
+                    Thread::sleep(pollIntervalMs);
+                    continue;
+                }
+
+                finished = true;
+            }
+
+            return 0;
+        }
+
+        //  maxBytesToRead ֽڲŷأ߳Ҫ˳(ȡWAVͷʱʹ)
+        int read(void* destBuffer, int maxBytesToRead) override
+        {
+            auto numRead = 0;
+
+            while (numRead < maxBytesToRead)
+            {
+                auto result = readAvailable(static_cast<char*>(destBuffer) + numRead, maxBytesToRead - numRead);
+                if (result <= 0)
+                    break;
+
+                numRead += result;
+            }
+
+            return numRead;
+        }
+
+        int64 getTotalLength() override { return -1; }
+        bool isExhausted() override { return finished; }
+        int64 getPosition() override { return position; }
+        bool setPosition(int64) override { return false; }
+
+    private:
+        enum { pollIntervalMs = 50 };
+
+        bool waitUntilReadable()
+        {
+            while (!thread.threadShouldExit())
+            {
+                pollfd pfd { fd, POLLIN, 0 };
+                auto result = ::poll(&pfd, 1, pollIntervalMs);
+
+                if (result > 0)
+                    return true;
+
+                if (result < 0 && errno != EINTR)
+                    return false;
+            }
+
+            return false;
+        }
+
+        const Thread& thread;
+        const bool isStandardInput;
+        int fd = -1;
+        bool finished = false, hasReceivedData = false;
+        int64 position = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PipeInputStream)
+    };
+}
+#endif
+
+//==============================================================================
+StreamInputSource::StreamInputSource(const String& streamPath, const Format& streamFormat)
+    : Thread("Stream Input"),
+    path(streamPath),
+    format(streamFormat)
+{
+}
+
+StreamInputSource::~StreamInputSource()
+{
+    // ȡ߳ÿ50msһǷҪ˳ᱻеĹܵ
+    stopThread(1000);
+}
+
+std::unique_ptr<StreamInputSource> StreamInputSource::createFromCommandLine(const String& commandLine)
+{
+    auto args = StringArray::fromTokens(commandLine, true);
+
+    auto getOption = [&args](const String& name, const String& defaultValue)
+    {
+        for (auto& arg : args)
+            if (arg.startsWith(name + "="))
+                return arg.fromFirstOccurrenceOf("=", false, false).unquoted();
+
+        return defaultValue;
+    };
+
+    auto streamPath = getOption("--stream", {});
+    if (streamPath.isEmpty())
+        return nullptr;
+
+   #if JUCE_WINDOWS
+    // Windows ܵͱ׼벻pollȴݲ֧
+    std::cerr << "--stream is not supported on Windows, ignoring " << streamPath << std::endl;
+    return nullptr;
+   #else
+    Format streamFormat;
+    auto encoding = getOption("--stream-format", "wav");
+
+    if (encoding == "s16le")
+        streamFormat.encoding = Format::pcm16;
+    else if (encoding == "s24le")
+        streamFormat.encoding = Format::pcm24;
+    else if (encoding == "f32le")
+        streamFormat.encoding = Format::float32;
+
+    streamFormat.sampleRate = jmax(1.0, getOption("--stream-rate", "44100").getDoubleValue());
+    streamFormat.numChannels = jmax(1, getOption("--stream-channels", "2").getIntValue());
+
+    return std::make_unique<StreamInputSource>(streamPath, streamFormat);
+   #endif
+}
+
+String StreamInputSource::getLastError() const
+{
+    const ScopedLock sl(errorLock);
+    return lastError;
+}
+
+void StreamInputSource::setError(const String& message)
+{
+    {
+        const ScopedLock sl(errorLock);
+        lastError = message;
+    }
+
+    sendChangeMessage();
+}
+
+//==============================================================================
+void StreamInputSource::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    if (!isReady())
+    {
+        bufferToFill.clearActiveBufferRegion();
+        return;
+    }
+
+    jitterBuffer->read(bufferToFill);
+    position += bufferToFill.numSamples;
+}
+
+int64 StreamInputSource::getTotalLength() const
+{
+    // һ󳤶Ϊ0AudioTransportSource ֹͣ
+    if (isReady() && jitterBuffer->isExhausted())
+        return 0;
+
+    return std::numeric_limits<int64>::max() / 4;
+}
+
+//==============================================================================
+void StreamInputSource::run()
+{
+   #if JUCE_WINDOWS
+    setError("Streams are not supported on Windows");
+   #else
+    PipeInputStream input(path, *this);
+
+    if (!input.openedOk())
+    {
+        setError("Cannot open stream " + getName());
+        return;
+    }
+
+    if (format.encoding == Format::wavStream && !readWavHeader(input))
+    {
+        setError("Unsupported WAV stream " + getName());
+        return;
+    }
+
+    // ӳٷΧ5ms ~ 500msʼ40ms10ûǷʱСĿӳ
+    auto rate = format.sampleRate;
+    jitterBuffer.reset(new JitterBuffer((int)rate, (int)(rate * 0.005), (int)(rate * 0.04), (int)(rate * 0.5), (int)(rate * 10.0)));
+
+    ready = true;
+    sendChangeMessage();
+
+    const int framesPerChunk = 1024;
+    auto bytesPerFrame = getBytesPerSample() * format.numChannels;
+
+    HeapBlock<char> data((size_t)(framesPerChunk * bytesPerFrame));
+    AudioSampleBuffer decoded(2, framesPerChunk);
+    int numPendingBytes = 0;
+
+    while (!threadShouldExit())
+    {
+        auto bytesRead = input.readAvailable(data + numPendingBytes, framesPerChunk * bytesPerFrame - numPendingBytes);
+
+        if (bytesRead <= 0)
+            break;
+
+        // ܵÿηصֽһ֡ʣֽһ
+        numPendingBytes += bytesRead;
+        auto numFrames = numPendingBytes / bytesPerFrame;
+        decode(data, numFrames, decoded);
+
+        auto numLeftoverBytes = numPendingBytes - numFrames * bytesPerFrame;
+        memmove(data, data + numFrames * bytesPerFrame, (size_t)numLeftoverBytes);
+        numPendingBytes = numLeftoverBytes;
+
+        // ﵽˮλʱȴŶ˶ȡٶܵѹɹܵ
+        for (auto written = 0; written < numFrames && !threadShouldExit();)
+        {
+            auto numToWrite = jmin(numFrames - written, jitterBuffer->getNumSamplesWritable());
+
+            if (numToWrite <= 0)
+            {
+                wait(5);
+                continue;
+            }
+
+            jitterBuffer->write(decoded, written, numToWrite);
+            written += numToWrite;
+        }
+    }
+
+    jitterBuffer->setEndOfStream();
+   #endif
+}
+
+bool StreamInputSource::readWavHeader(InputStream& input)
+{
+    char id[4];
+
+    if (input.read(id, 4) != 4 || memcmp(id, "RIFF", 4) != 0)
+        return false;
+
+    input.readInt(); // RIFFȣͨΪ0Чֵ
+
+    if (input.read(id, 4) != 4 || memcmp(id, "WAVE", 4) != 0)
+        return false;
+
+    auto haveFormat = false;
+
+    while (!threadShouldExit() && input.read(id, 4) == 4)
+    {
+        auto chunkSize = (uint32)input.readInt();
+
+        if (memcmp(id, "data", 4) == 0)
+            return haveFormat; // ʹdataĳȣһֱ
+
+        MemoryBlock chunk;
+        if (input.readIntoMemoryBlock(chunk, (ssize_t)(chunkSize + (chunkSize & 1))) < (size_t)chunkSize)
+            return false;
+
+        if (memcmp(id, "fmt ", 4) != 0 || chunkSize < 16)
+            continue;
+
+        auto* bytes = static_cast<const char*>(chunk.getData());
+        auto formatTag = ByteOrder::littleEndianShort(bytes);
+        format.numChannels = (int)ByteOrder::littleEndianShort(bytes + 2);
+        format.sampleRate = (double)ByteOrder::littleEndianInt(bytes + 4);
+        auto bitsPerSample = (int)ByteOrder::littleEndianShort(bytes + 14);
+
+        // WAVE_FORMAT_EXTENSIBLEʵʸʽSubFormat GUIDǰֽ
+        if (formatTag == 0xfffe && chunkSize >= 26)
+            formatTag = ByteOrder::littleEndianShort(bytes + 24);
+
+        if (formatTag == 1 && bitsPerSample == 16)
+            format.encoding = Format::pcm16;
+        else if (formatTag == 1 && bitsPerSample == 24)
+            format.encoding = Format::pcm24;
+        else if (formatTag == 3 && bitsPerSample == 32)
+            format.encoding = Format::float32;
+        else
+            return false;
+
+        haveFormat = format.numChannels > 0 && format.sampleRate > 0.0;
+    }
+
+    return false;
+}
+
+int StreamInputSource::getBytesPerSample() const noexcept
+{
+    switch (format.encoding)
+    {
+    case Format::pcm24:
+        return 3;
+    case Format::float32:
+        return 4;
+    default:
+        return 2;
+    }
+}
+
+void StreamInputSource::decode(const char* data, int numFrames, AudioSampleBuffer& dest) const
+{
+    auto bytesPerSample = getBytesPerSample();
+
+    // Ƶʱֻȡǰ
+    for (auto channel = 0; channel < dest.getNumChannels(); ++channel)
+    {
+        auto* out = dest.getWritePointer(channel);
+        const auto* in = data + jmin(channel, format.numChannels - 1) * bytesPerSample;
+        auto stride = format.numChannels * bytesPerSample;
+
+        for (auto frame = 0; frame < numFrames; ++frame, in += stride)
+        {
+            switch (format.encoding)
+            {
+            case Format::pcm24:
+                out[frame] = (float)ByteOrder::littleEndian24Bit(in) / 8388608.0f;
+                break;
+            case Format::float32:
+            {
+                auto bits = ByteOrder::littleEndianInt(in);
+                memcpy(out + frame, &bits, sizeof(float));
+                break;
+            }
+            default:
+                out[frame] = (float)(int16)ByteOrder::littleEndianShort(in) / 32768.0f;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "JitterBuffer.h"
+
+using namespace juce;
+//==============================================================================
+
+// ܵ(FIFO)׼ȡ̲ƵԭʼPCMWAV
+// ̶̨߳ȡ룬Ӧ󽻸 AudioTransportSource 
+// У --stream=<FIFO· - ʾ׼> [--stream-format=wav|s16le|s24le|f32le]
+//          [--stream-rate=44100] [--stream-channels=2]  (ֻԭʼPCM)
+// ֻ֧LinuxmacOSWindows createFromCommandLine()  --stream nullptr
+class StreamInputSource : public juce::PositionableAudioSource, public juce::ChangeBroadcaster, private juce::Thread
+{
+public:
+    struct Format
+    {
+        enum Encoding { wavStream, pcm16, pcm24, float32 };
+
+        Encoding encoding = wavStream;
+        double sampleRate = 44100.0;
+        int numChannels = 2;
+    };
+
+    StreamInputSource(const juce::String& path, const Format& format);
+    ~StreamInputSource() override;
+
+    // û --stream ʱnullptr
+    static std::unique_ptr<StreamInputSource> createFromCommandLine(const juce::String& commandLine);
+
+    void start() { startThread(); }
+
+    // ʽ(WAVͷ)ѶȡԿʼ
+    bool isReady() const noexcept { return ready.load(); }
+    juce::String getName() const { return path == "-" ? juce::String("stdin") : path; }
+    juce::String getLastError() const;
+    double getSampleRate() const noexcept { return format.sampleRate; }
+
+    // ״̬δʱnullptr
+    const JitterBuffer* getJitterBuffer() const noexcept { return isReady() ? jitterBuffer.get() : nullptr; }
+
+    //==============================================================================
+    void prepareToPlay(int, double) override {}
+    void releaseResources() override {}
+    void getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill) override;
+
+    // ʵʱܶλȡλֻѲŵĲ
+    void setNextReadPosition(juce::int64) override {}
+    juce::int64 getNextReadPosition() const override { return position.load(); }
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override { return false; }
+
+private:
+    //==============================================================================
+    void run() override;
+
+    bool readWavHeader(juce::InputStream& input);
+    int getBytesPerSample() const noexcept;
+    void decode(const char* data, int numFrames, juce::AudioSampleBuffer& dest) const;
+    void setError(const juce::String& message);
+
+    const juce::String path;
+    Format format;
+
+    std::unique_ptr<JitterBuffer> jitterBuffer;
+    std::atomic<bool> ready { false };
+    std::atomic<juce::int64> position { 0 }; //Ƶ߳д룬Ϣ߳ͨ AudioTransportSource ȡ
+
+    juce::CriticalSection errorLock;
+    juce::String lastError;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamInputSource)
+};
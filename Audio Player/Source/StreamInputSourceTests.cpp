@@ -0,0 +1,116 @@
+#include "StreamInputSource.h"
+
+#if ! JUCE_WINDOWS
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <thread>
+
+using namespace juce;
+
+//==============================================================================
+// ñFIFOдʵʱö鶶ᶪκβ
+class StreamInputSourceTests : public UnitTest
+{
+public:
+    StreamInputSourceTests() : UnitTest("StreamInputSource", "Audio Player") {}
+
+    void runTest() override
+    {
+        beginTest("Producer faster than real time loses no samples");
+
+        const double sampleRate = 48000.0;
+        const int numFrames = 48000 * 2;
+        const int blockSize = 480;
+
+        TemporaryFile fifoFile;
+        auto fifoPath = fifoFile.getFile().getFullPathName();
+        if (mkfifo(fifoPath.toRawUTF8(), 0600) != 0)
+        {
+            expect(false, "mkfifo failed");
+            return;
+        }
+
+        StreamInputSource::Format format;
+        format.encoding = StreamInputSource::Format::pcm16;
+        format.sampleRate = sampleRate;
+        format.numChannels = 1;
+
+        StreamInputSource source(fifoPath, format);
+        source.start();
+
+        // ʵʱٶȣһԾдꣻֵΪ 1..30000 ѭ0
+        std::thread generator([&fifoPath, numFrames]
+        {
+            auto fd = ::open(fifoPath.toRawUTF8(), O_WRONLY);
+            if (fd < 0)
+                return;
+
+            HeapBlock<uint16> samples((size_t)numFrames);
+            for (auto i = 0; i < numFrames; ++i)
+                samples[i] = ByteOrder::swapIfBigEndian((uint16)(1 + i % 30000));
+
+            auto* data = reinterpret_cast<const char*>(samples.get());
+            auto numBytes = (ssize_t)numFrames * 2;
+
+            for (ssize_t written = 0; written < numBytes;)
+            {
+                auto result = ::write(fd, data + written, (size_t)(numBytes - written));
+                if (result <= 0)
+                    break;
+                written += result;
+            }
+
+            ::close(fd);
+        });
+
+        // Ŷ˰ȡÿ֮ߣöࣻ;ͣһΣģ⻺д
+        AudioSampleBuffer block(2, blockSize);
+        int numReceived = 0, expectedValue = 1;
+        auto inOrder = true, paused = false;
+        auto timeout = Time::getMillisecondCounter() + 20000;
+
+        while (source.getTotalLength() > 0 && Time::getMillisecondCounter() < timeout)
+        {
+            source.getNextAudioBlock(AudioSourceChannelInfo(block));
+
+            for (auto i = 0; i < blockSize; ++i)
+            {
+                auto value = roundToInt(block.getSample(0, i) * 32768.0f);
+
+                // Ƿʱľ
+                if (value == 0)
+                    continue;
+
+                inOrder = inOrder && value == expectedValue;
+                expectedValue = expectedValue % 30000 + 1;
+                ++numReceived;
+            }
+
+            Thread::sleep(2);
+
+            if (!paused && numReceived > numFrames / 4)
+            {
+                paused = true;
+                Thread::sleep(300);
+            }
+        }
+
+        generator.join();
+
+        expect(source.getLastError().isEmpty(), source.getLastError());
+        expect(source.getTotalLength() == 0, "stream did not finish");
+        expect(source.getJitterBuffer() != nullptr);
+
+        if (auto* jitterBuffer = source.getJitterBuffer())
+            expectEquals(jitterBuffer->getNumDroppedSamples(), 0);
+
+        expectEquals(numReceived, numFrames);
+        expect(inOrder, "samples arrived out of order");
+    }
+};
+
+static StreamInputSourceTests streamInputSourceTests;
+
+#endif
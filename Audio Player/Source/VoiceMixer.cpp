@@ -0,0 +1,259 @@
+#include "VoiceMixer.h"
+
+using namespace juce;
+
+//==============================================================================
+bool VoiceMixer::VoiceQueue::push(Voice* voice) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+        return false;
+
+    slots[size1 > 0 ? start1 : start2] = voice;
+    fifo.finishedWrite(1);
+    return true;
+}
+
+VoiceMixer::Voice* VoiceMixer::VoiceQueue::pop() noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+        return nullptr;
+
+    auto* voice = slots[size1 > 0 ? start1 : start2];
+    fifo.finishedRead(1);
+    return voice;
+}
+
+//==============================================================================
+VoiceMixer::VoiceMixer()
+{
+    // Ԥȷ䣬ʱ·
+    voices.ensureStorageAllocated(maxVoices);
+}
+
+VoiceMixer::~VoiceMixer()
+{
+    // ʱƵ豸ѾֹͣкƵ߳еָ붼ٱʹ
+    for (auto* voice : voices)
+        voice->getOutput().releaseResources();
+
+    voices.clear();
+
+    for (auto* thread : decodeThreads)
+        thread->stopThread(2000);
+}
+
+//==============================================================================
+void VoiceMixer::prepareToPlay(int samplesPerBlockExpected, double newSampleRate)
+{
+    // 豸֮ǰãʱûƵصֱӷƵ̵߳
+    sampleRate = newSampleRate;
+    blockSize = samplesPerBlockExpected;
+    scratchBuffer.setSize(2, jmax(1, samplesPerBlockExpected));
+
+    takePendingVoices();
+
+    for (auto i = 0; i < numActiveVoices; ++i)
+        prepareVoice(*activeVoices[i], samplesPerBlockExpected, newSampleRate);
+}
+
+void VoiceMixer::releaseResources()
+{
+    for (auto i = 0; i < numActiveVoices; ++i)
+        activeVoices[i]->getOutput().releaseResources();
+}
+
+void VoiceMixer::prepareVoice(Voice& voice, int samplesPerBlockExpected, double deviceSampleRate)
+{
+    if (deviceSampleRate <= 0.0)
+        return;
+
+    if (voice.sourceSampleRate != deviceSampleRate)
+    {
+        if (voice.resamplingSource == nullptr)
+            voice.resamplingSource.reset(new ResamplingAudioSource(voice.bufferingSource.get(), false, 2));
+
+        voice.resamplingSource->setResamplingRatio(voice.sourceSampleRate / deviceSampleRate);
+    }
+    else
+    {
+        voice.resamplingSource.reset();
+    }
+
+    voice.getOutput().prepareToPlay(samplesPerBlockExpected, deviceSampleRate);
+    voice.preparedSampleRate = deviceSampleRate;
+    voice.preparedBlockSize = samplesPerBlockExpected;
+}
+
+void VoiceMixer::takePendingVoices()
+{
+    auto currentSampleRate = sampleRate.load();
+    auto currentBlockSize = blockSize.load();
+
+    while (auto* voice = pendingVoices.pop())
+    {
+        // Ϣ߳׼ڼ豸ã˻ȥµ׼
+        if (voice->preparedSampleRate != currentSampleRate || voice->preparedBlockSize != currentBlockSize)
+        {
+            if (returnedVoices.push(voice))
+                continue;
+        }
+
+        jassert(numActiveVoices < maxVoices);
+        activeVoices[numActiveVoices++] = voice;
+    }
+}
+
+bool VoiceMixer::isFinished(const Voice& voice) const
+{
+    return voice.bufferingSource->getNextReadPosition() >= voice.bufferingSource->getTotalLength();
+}
+
+//==============================================================================
+void VoiceMixer::addNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    takePendingVoices();
+
+    if (numActiveVoices == 0)
+        return;
+
+    auto numChannels = jmin(2, bufferToFill.buffer->getNumChannels());
+
+    // 豸ĿԤڴʱֶδ֤ʱ·
+    for (auto offset = 0; offset < bufferToFill.numSamples; offset += scratchBuffer.getNumSamples())
+    {
+        auto numSamples = jmin(scratchBuffer.getNumSamples(), bufferToFill.numSamples - offset);
+        AudioSourceChannelInfo voiceInfo(&scratchBuffer, 0, numSamples);
+
+        for (auto i = 0; i < numActiveVoices; ++i)
+        {
+            auto* voice = activeVoices[i];
+            voice->getOutput().getNextAudioBlock(voiceInfo);
+
+            auto gain = voice->gain.load();
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+            {
+                auto destStart = bufferToFill.startSample + offset;
+
+                if (gain == voice->lastGain)
+                    FloatVectorOperations::addWithMultiply(bufferToFill.buffer->getWritePointer(channel, destStart),
+                        scratchBuffer.getReadPointer(channel), gain, numSamples);
+                else
+                    bufferToFill.buffer->addFromWithRamp(channel, destStart, scratchBuffer.getReadPointer(channel),
+                        numSamples, voice->lastGain, gain);
+            }
+
+            voice->lastGain = gain;
+        }
+    }
+
+    // ƳϢ߳ɾ(һƶ)
+    for (auto i = numActiveVoices; --i >= 0;)
+    {
+        auto* voice = activeVoices[i];
+
+        if ((voice->removeRequested.load() || isFinished(*voice)) && returnedVoices.push(voice))
+            activeVoices[i] = activeVoices[--numActiveVoices];
+    }
+}
+
+//==============================================================================
+int VoiceMixer::addVoice(AudioFormatReader* reader, float gain)
+{
+    std::unique_ptr<AudioFormatReader> ownedReader(reader);
+
+    if (ownedReader == nullptr || voices.size() >= maxVoices)
+        return -1;
+
+    // ߳ڵһʱŴ
+    if (decodeThreads.isEmpty())
+    {
+        auto numThreads = jlimit(1, (int)maxDecodeThreads, SystemStats::getNumCpus() - 1);
+
+        for (auto i = 0; i < numThreads; ++i)
+            decodeThreads.add(new TimeSliceThread("Voice Decoder " + String(i)));
+    }
+
+    // 䵽߳
+    auto* thread = decodeThreads[nextDecodeThread];
+    nextDecodeThread = (nextDecodeThread + 1) % decodeThreads.size();
+
+    if (!thread->isThreadRunning())
+        thread->startThread();
+
+    auto voice = std::make_unique<Voice>();
+    voice->id = nextVoiceId++;
+    voice->sourceSampleRate = ownedReader->sampleRate;
+    voice->gain = gain;
+    voice->lastGain = gain;
+    voice->bufferingSource.reset(new BufferingAudioSource(new AudioFormatReaderSource(ownedReader.release(), true),
+        *thread, true, readAheadSamples, 2, false));
+
+    // ׼ʱȴԤ(prefill=false)һӺܶҲ棻
+    // ߳仺֮ǰ
+    prepareVoice(*voice, blockSize.load(), sampleRate.load());
+
+    auto* added = voices.add(voice.release());
+    numVoices = voices.size();
+
+    auto queued = pendingVoices.push(added);
+    jassert(queued); //  maxVoicesвд
+    ignoreUnused(queued);
+
+    return added->id;
+}
+
+void VoiceMixer::setVoiceGain(int voiceId, float gain)
+{
+    auto index = indexOfVoice(voiceId);
+    if (index >= 0)
+        voices.getUnchecked(index)->gain = gain;
+}
+
+void VoiceMixer::removeVoice(int voiceId)
+{
+    // ֻǣƵ̰߳Żضк removeFinishedVoices() ɾ
+    auto index = indexOfVoice(voiceId);
+    if (index >= 0)
+        voices.getUnchecked(index)->removeRequested = true;
+}
+
+void VoiceMixer::removeFinishedVoices()
+{
+    while (auto* voice = returnedVoices.pop())
+    {
+        if (voice->removeRequested.load() || isFinished(*voice))
+        {
+            voice->getOutput().releaseResources();
+            voices.removeObject(voice);
+            continue;
+        }
+
+        // 豸øı˻ص׼ٽƵ߳
+        prepareVoice(*voice, blockSize.load(), sampleRate.load());
+        pendingVoices.push(voice);
+    }
+
+    numVoices = voices.size();
+}
+
+void VoiceMixer::removeAllVoices()
+{
+    for (auto* voice : voices)
+        voice->removeRequested = true;
+}
+
+int VoiceMixer::indexOfVoice(int voiceId) const
+{
+    for (auto i = 0; i < voices.size(); ++i)
+        if (voices.getUnchecked(i)->id == voiceId)
+            return i;
+
+    return -1;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+using namespace juce;
+//==============================================================================
+
+// ļͬʱŵĻ
+// ÿڽ̳߳еĳ߳Ԥ(BufferingAudioSourceԤȹ̶)
+// Ƶֻ߳ԤݲӣÿĿǹ̶
+// Ƶ̲߳Ϣ߳׼õͨнƵ̣߳Ƴ
+// Ƶ̷߳ŻһУϢ߳ removeFinishedVoices() ɾ
+class VoiceMixer
+{
+public:
+    enum
+    {
+        maxVoices = 512,
+        readAheadSamples = 16384, //ÿԤȣÿڴ
+        maxDecodeThreads = 8
+    };
+
+    VoiceMixer();
+    ~VoiceMixer();
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate);
+    void releaseResources();
+
+    // Ƶ̣߳ӵ(ջԭе)
+    void addNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill);
+
+    // Ϣ̣߳ӹreaderţʧܷ-1
+    int addVoice(juce::AudioFormatReader* reader, float gain);
+    void setVoiceGain(int voiceId, float gain);
+    void removeVoice(int voiceId);
+    void removeFinishedVoices(); // ɾƵ̷߳Żصɶʱڵ
+    void removeAllVoices();
+
+    // Ƶ߳ҲԵ
+    int getNumVoices() const noexcept { return numVoices.load(); }
+
+private:
+    //==============================================================================
+    struct Voice
+    {
+        int id = 0;
+        std::unique_ptr<juce::BufferingAudioSource> bufferingSource;
+        std::unique_ptr<juce::ResamplingAudioSource> resamplingSource; //ļ豸ͬʱʹ
+        double sourceSampleRate = 0.0;
+        std::atomic<float> gain { 1.0f };
+        std::atomic<bool> removeRequested { false };
+        float lastGain = 1.0f;
+
+        // ׼ʱʹõ豸ã뵱ǰòͬʱƵ̻߳˻Ϣ߳׼
+        double preparedSampleRate = 0.0;
+        int preparedBlockSize = 0;
+
+        juce::AudioSource& getOutput()
+        {
+            if (resamplingSource != nullptr)
+                return *resamplingSource;
+
+            return *bufferingSource;
+        }
+    };
+
+    // /ߵָУ㹻д
+    struct VoiceQueue
+    {
+        bool push(Voice* voice) noexcept;
+        Voice* pop() noexcept;
+
+        juce::AbstractFifo fifo { maxVoices + 1 };
+        Voice* slots[maxVoices + 1] = {};
+    };
+
+    void prepareVoice(Voice& voice, int samplesPerBlockExpected, double deviceSampleRate);
+    void takePendingVoices();
+    bool isFinished(const Voice& voice) const;
+    int indexOfVoice(int voiceId) const;
+
+    juce::OwnedArray<juce::TimeSliceThread> decodeThreads;
+    int nextDecodeThread = 0;
+
+    // Ϣ̣߳ӵ
+    juce::OwnedArray<Voice> voices;
+    std::atomic<int> numVoices { 0 };
+    int nextVoiceId = 1;
+
+    VoiceQueue pendingVoices;  // Ϣ߳ -> Ƶ߳
+    VoiceQueue returnedVoices; // Ƶ߳ -> Ϣ߳
+
+    // Ƶ߳(Լ豸ֹͣʱ prepareToPlay/releaseResources)ڲŵ
+    Voice* activeVoices[maxVoices] = {};
+    int numActiveVoices = 0;
+    juce::AudioSampleBuffer scratchBuffer;
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<int> blockSize { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoiceMixer)
+};